@@ -0,0 +1,251 @@
+/*
+ * Encode/decode throughput of libjpeg's scanline API (the one Pl_DCT
+ * drives) against the TurboJPEG tj3 whole-buffer API. Both run on the
+ * same in-memory image with the same timing loop, so the numbers cover
+ * codec work only: no process startup and no file I/O.
+ *
+ * Prints a Markdown table to stdout.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <jpeglib.h>
+#include <turbojpeg.h>
+
+#ifndef WIDTH
+# define WIDTH 6000
+#endif
+#ifndef HEIGHT
+# define HEIGHT 4000
+#endif
+#ifndef MIN_SECONDS
+# define MIN_SECONDS 3.0
+#endif
+#define QUALITY 95
+
+struct bench
+{
+    unsigned char* rgb;
+    unsigned char* jpeg;
+    unsigned long jpeg_size;
+    unsigned char* out;
+    int fast;
+    tjhandle compressor;
+    tjhandle decompressor;
+    unsigned char* tj_buf;
+};
+
+static double
+now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void
+tj_check(tjhandle handle, int status, const char* what)
+{
+    if (status != 0) {
+        fprintf(stderr, "%s: %s\n", what, tj3GetErrorStr(handle));
+        exit(2);
+    }
+}
+
+static unsigned char*
+make_image(void)
+{
+    unsigned char* rgb = malloc((size_t)WIDTH * HEIGHT * 3);
+    if (rgb == NULL) {
+        perror("malloc");
+        exit(2);
+    }
+    for (int y = 0; y < HEIGHT; ++y) {
+        unsigned char* row = rgb + (size_t)y * WIDTH * 3;
+        for (int x = 0; x < WIDTH; ++x) {
+            int v = (int)(127 + 127 * sin(x * 0.0021 + y * 0.0011));
+            row[3 * x] = (unsigned char)v;
+            row[3 * x + 1] = (unsigned char)((x + y) & 0xff);
+            row[3 * x + 2] = (unsigned char)((v ^ y) & 0xff);
+        }
+    }
+    return rgb;
+}
+
+static void
+scanline_encode(struct bench* b)
+{
+    struct jpeg_compress_struct cinfo;
+    struct jpeg_error_mgr jerr;
+    unsigned char* buf = NULL;
+    unsigned long size = 0;
+
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_compress(&cinfo);
+    jpeg_mem_dest(&cinfo, &buf, &size);
+    cinfo.image_width = WIDTH;
+    cinfo.image_height = HEIGHT;
+    cinfo.input_components = 3;
+    cinfo.in_color_space = JCS_RGB;
+    jpeg_set_defaults(&cinfo); // YCbCr 4:2:0
+    jpeg_set_quality(&cinfo, QUALITY, TRUE);
+    if (b->fast) {
+        cinfo.dct_method = JDCT_IFAST;
+    }
+    jpeg_start_compress(&cinfo, TRUE);
+    while (cinfo.next_scanline < cinfo.image_height) {
+        JSAMPROW row = b->rgb + (size_t)cinfo.next_scanline * WIDTH * 3;
+        jpeg_write_scanlines(&cinfo, &row, 1);
+    }
+    jpeg_finish_compress(&cinfo);
+    jpeg_destroy_compress(&cinfo);
+    free(buf);
+}
+
+static void
+scanline_decode(struct bench* b)
+{
+    struct jpeg_decompress_struct dinfo;
+    struct jpeg_error_mgr jerr;
+
+    dinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_decompress(&dinfo);
+    jpeg_mem_src(&dinfo, b->jpeg, b->jpeg_size);
+    jpeg_read_header(&dinfo, TRUE);
+    dinfo.out_color_space = JCS_RGB;
+    if (b->fast) {
+        dinfo.dct_method = JDCT_IFAST;
+        dinfo.do_fancy_upsampling = FALSE;
+    }
+    jpeg_start_decompress(&dinfo);
+    while (dinfo.output_scanline < dinfo.output_height) {
+        JSAMPROW row = b->out + (size_t)dinfo.output_scanline * WIDTH * 3;
+        jpeg_read_scanlines(&dinfo, &row, 1);
+    }
+    jpeg_finish_decompress(&dinfo);
+    jpeg_destroy_decompress(&dinfo);
+}
+
+static void
+tj3_encode(struct bench* b)
+{
+    size_t size = tj3JPEGBufSize(WIDTH, HEIGHT, TJSAMP_420);
+    tj_check(
+        b->compressor,
+        tj3Compress8(b->compressor, b->rgb, WIDTH, 0, HEIGHT, TJPF_RGB, &b->tj_buf, &size),
+        "tj3Compress8");
+}
+
+static void
+tj3_decode(struct bench* b)
+{
+    tj_check(
+        b->decompressor,
+        tj3Decompress8(b->decompressor, b->jpeg, b->jpeg_size, b->out, 0, TJPF_RGB),
+        "tj3Decompress8");
+}
+
+static double
+images_per_second(void (*fn)(struct bench*), struct bench* b)
+{
+    int n = 0;
+    double start;
+    double elapsed;
+
+    fn(b); // warm-up
+    start = now();
+    do {
+        fn(b);
+        ++n;
+        elapsed = now() - start;
+    } while (elapsed < MIN_SECONDS);
+    return n / elapsed;
+}
+
+static void
+setup_tj3(struct bench* b)
+{
+    b->compressor = tj3Init(TJINIT_COMPRESS);
+    b->decompressor = tj3Init(TJINIT_DECOMPRESS);
+    if (b->compressor == NULL || b->decompressor == NULL) {
+        fprintf(stderr, "tj3Init: %s\n", tj3GetErrorStr(NULL));
+        exit(2);
+    }
+    tj_check(b->compressor, tj3Set(b->compressor, TJPARAM_QUALITY, QUALITY), "TJPARAM_QUALITY");
+    tj_check(b->compressor, tj3Set(b->compressor, TJPARAM_SUBSAMP, TJSAMP_420), "TJPARAM_SUBSAMP");
+    tj_check(b->compressor, tj3Set(b->compressor, TJPARAM_NOREALLOC, 1), "TJPARAM_NOREALLOC");
+    tj_check(b->compressor, tj3Set(b->compressor, TJPARAM_FASTDCT, b->fast), "TJPARAM_FASTDCT");
+    tj_check(
+        b->decompressor, tj3Set(b->decompressor, TJPARAM_FASTDCT, b->fast), "TJPARAM_FASTDCT");
+    tj_check(
+        b->decompressor,
+        tj3Set(b->decompressor, TJPARAM_FASTUPSAMPLE, b->fast),
+        "TJPARAM_FASTUPSAMPLE");
+}
+
+int
+main(void)
+{
+    struct bench b = {0};
+    unsigned char* jpeg = NULL;
+    unsigned long jpeg_size = 0;
+    struct jpeg_compress_struct cinfo;
+    struct jpeg_error_mgr jerr;
+
+    b.rgb = make_image();
+    b.out = malloc((size_t)WIDTH * HEIGHT * 3);
+    b.tj_buf = tj3Alloc(tj3JPEGBufSize(WIDTH, HEIGHT, TJSAMP_420));
+    if (b.out == NULL || b.tj_buf == NULL) {
+        perror("malloc");
+        return 2;
+    }
+
+    // Both decoders read the same JPEG so they do identical work.
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_compress(&cinfo);
+    jpeg_mem_dest(&cinfo, &jpeg, &jpeg_size);
+    cinfo.image_width = WIDTH;
+    cinfo.image_height = HEIGHT;
+    cinfo.input_components = 3;
+    cinfo.in_color_space = JCS_RGB;
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_quality(&cinfo, QUALITY, TRUE);
+    jpeg_start_compress(&cinfo, TRUE);
+    while (cinfo.next_scanline < cinfo.image_height) {
+        JSAMPROW row = b.rgb + (size_t)cinfo.next_scanline * WIDTH * 3;
+        jpeg_write_scanlines(&cinfo, &row, 1);
+    }
+    jpeg_finish_compress(&cinfo);
+    jpeg_destroy_compress(&cinfo);
+    b.jpeg = jpeg;
+    b.jpeg_size = jpeg_size;
+
+    printf("### JPEG throughput (%dx%d RGB, quality %d, 4:2:0)\n\n", WIDTH, HEIGHT, QUALITY);
+    printf("| API | options | encode images/s | decode images/s |\n");
+    printf("| --- | --- | --- | --- |\n");
+    for (b.fast = 0; b.fast <= 1; ++b.fast) {
+        const char* options = b.fast ? "fast DCT + fast upsample" : "default";
+        double enc;
+        double dec;
+
+        enc = images_per_second(scanline_encode, &b);
+        dec = images_per_second(scanline_decode, &b);
+        printf("| libjpeg scanline | %s | %.2f | %.2f |\n", options, enc, dec);
+
+        setup_tj3(&b);
+        enc = images_per_second(tj3_encode, &b);
+        dec = images_per_second(tj3_decode, &b);
+        printf("| tj3 whole-buffer | %s | %.2f | %.2f |\n", options, enc, dec);
+        tj3Destroy(b.compressor);
+        tj3Destroy(b.decompressor);
+    }
+
+    tj3Free(b.tj_buf);
+    free(jpeg);
+    free(b.out);
+    free(b.rgb);
+    return 0;
+}